@@ -0,0 +1,104 @@
+#include "pyramid/static_index.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/// @brief The number of keys in the benchmarked index, unless overridden on the command line.
+#define BENCH_DEFAULT_KEYS ((size_t)1 << 24)
+
+/// @brief The number of lookups performed by each benchmark.
+#define BENCH_QUERIES ((size_t)1 << 22)
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t xorshift(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/// @brief Binary search over da_data(), the way read-mostly tables are searched without an index.
+static size_t binary_lower_bound(const dynamic_array *keys, uint64_t key) {
+    const uint64_t *data = (const uint64_t *)da_data(keys);
+    size_t lo = 0, hi = da_size(keys);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (compare_u64(&data[mid], &key) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static void report(const char *name, double seconds, size_t checksum) {
+    printf(
+        "%-22s %8.1f ns/lookup  (checksum %zu)\n",
+        name,
+        seconds * 1e9 / (double)BENCH_QUERIES,
+        checksum);
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : BENCH_DEFAULT_KEYS;
+
+    int status        = EXIT_FAILURE;
+    uint64_t *queries = NULL;
+    size_t *results   = NULL;
+    static_index *si  = NULL;
+
+    dynamic_array *keys = da_create(sizeof(uint64_t));
+    if (!keys) return EXIT_FAILURE;
+
+    da_reserve(keys, n);
+    if (da_capacity(keys) < n) goto done;
+    for (uint64_t i = 0; i < n; i++) da_push(keys, &(uint64_t){3 * i});
+
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    queries        = (uint64_t *)malloc(BENCH_QUERIES * sizeof(uint64_t));
+    results        = (size_t *)malloc(BENCH_QUERIES * sizeof(size_t));
+    if (!queries || !results) goto done;
+    for (size_t i = 0; i < BENCH_QUERIES; i++) queries[i] = xorshift(&state) % (3 * n + 1);
+
+    double start = now();
+    si           = si_create(keys, compare_u64);
+    printf("%zu keys, built index in %.1f ms\n", n, (now() - start) * 1e3);
+    if (!si) goto done;
+
+    size_t checksum = 0;
+    start           = now();
+    for (size_t i = 0; i < BENCH_QUERIES; i++) checksum += binary_lower_bound(keys, queries[i]);
+    report("binary search", now() - start, checksum);
+
+    checksum = 0;
+    start    = now();
+    for (size_t i = 0; i < BENCH_QUERIES; i++) checksum += si_lower_bound(si, &queries[i]);
+    report("si_lower_bound", now() - start, checksum);
+
+    checksum = 0;
+    start    = now();
+    si_lower_bound_batch(si, queries, BENCH_QUERIES, results);
+    for (size_t i = 0; i < BENCH_QUERIES; i++) checksum += results[i];
+    report("si_lower_bound_batch", now() - start, checksum);
+
+    status = EXIT_SUCCESS;
+
+done:
+    si_destroy(si);
+    free(results);
+    free(queries);
+    da_destroy(keys);
+
+    return status;
+}
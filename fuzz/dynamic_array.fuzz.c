@@ -0,0 +1,209 @@
+#include "pyramid/dynamic_array.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The largest number of elements an input is allowed to grow a dynamic array to, so that
+/// inputs exercise the dynamic array rather than the allocator.
+#define FUZZ_MAX_ELEMS 4096
+
+/// @brief Abort, so that the fuzzer records the input, if cond does not hold.
+#define FUZZ_CHECK(cond)                                                             \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            abort();                                                                 \
+        }                                                                            \
+    } while (0)
+
+/// @brief The operations an input can apply, one per leading byte.
+enum fuzz_op {
+    FUZZ_PUSH,
+    FUZZ_POP,
+    FUZZ_INSERT,
+    FUZZ_ERASE,
+    FUZZ_ERASE_RANGE,
+    FUZZ_SET,
+    FUZZ_RESIZE,
+    FUZZ_RESIZE_UNINITIALIZED,
+    FUZZ_RESERVE,
+    FUZZ_APPEND,
+    FUZZ_CLEAR,
+    FUZZ_DUP,
+    FUZZ_OP_COUNT,
+};
+
+/// @brief The unread remainder of an input.
+struct fuzz_input {
+    const uint8_t *data;
+    size_t size;
+};
+
+/// @brief A trivially correct reference model of a dynamic array of uint32_t.
+struct fuzz_model {
+    size_t size;
+    uint32_t data[FUZZ_MAX_ELEMS];
+};
+
+/// @brief Consume up to four bytes of an input as a little-endian integer. Exhausted inputs read
+/// as zero.
+static uint32_t fuzz_take(struct fuzz_input *in, size_t bytes) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < bytes && in->size; i++, in->data++, in->size--) {
+        value |= (uint32_t)*in->data << (8 * i);
+    }
+    return value;
+}
+
+/// @brief Abort unless a dynamic array holds exactly the contents of a reference model.
+static void fuzz_check_matches(const dynamic_array *da, const struct fuzz_model *m) {
+    FUZZ_CHECK(da_size(da) == m->size);
+    FUZZ_CHECK(da_capacity(da) >= da_size(da));
+    FUZZ_CHECK(da_is_empty(da) == (m->size == 0));
+    if (m->size) {
+        FUZZ_CHECK(!memcmp(da_data(da), m->data, m->size * sizeof(uint32_t)));
+        FUZZ_CHECK(*(uint32_t *)da_front(da) == m->data[0]);
+        FUZZ_CHECK(*(uint32_t *)da_back(da) == m->data[m->size - 1]);
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static struct fuzz_model m;
+    static uint32_t scratch[FUZZ_MAX_ELEMS];
+
+    struct fuzz_input in = {data, size};
+    dynamic_array *da    = da_create(sizeof(uint32_t));
+    FUZZ_CHECK(da);
+    m.size = 0;
+
+    while (in.size) {
+        enum fuzz_op op = (enum fuzz_op)(fuzz_take(&in, 1) % FUZZ_OP_COUNT);
+
+        // Indices may land one past the end (valid for insertion) or further (a no-op).
+        size_t i       = fuzz_take(&in, 2) % (m.size + 2);
+        size_t room    = FUZZ_MAX_ELEMS - m.size;
+        uint32_t value = fuzz_take(&in, 4);
+
+        switch (op) {
+            case FUZZ_PUSH:
+                if (!room) break;
+                da_push(da, &value);
+                m.data[m.size++] = value;
+                break;
+            case FUZZ_POP: {
+                uint32_t popped = 0;
+                da_pop(da, &popped);
+                if (m.size) FUZZ_CHECK(popped == m.data[--m.size]);
+                break;
+            }
+            case FUZZ_INSERT:
+                if (!room) break;
+                da_insert(da, i, &value);
+                if (i > m.size) break;
+                memmove(&m.data[i + 1], &m.data[i], (m.size - i) * sizeof(uint32_t));
+                m.data[i] = value;
+                m.size++;
+                break;
+            case FUZZ_ERASE: {
+                uint32_t erased = 0;
+                da_erase(da, i, &erased);
+                if (i >= m.size) break;
+                FUZZ_CHECK(erased == m.data[i]);
+                memmove(&m.data[i], &m.data[i + 1], (m.size - i - 1) * sizeof(uint32_t));
+                m.size--;
+                break;
+            }
+            case FUZZ_ERASE_RANGE: {
+                size_t last = i + value % (m.size + 2);
+                da_erase_range(da, i, last, scratch);
+                if (i >= last || last > m.size) break;
+                FUZZ_CHECK(!memcmp(scratch, &m.data[i], (last - i) * sizeof(uint32_t)));
+                memmove(&m.data[i], &m.data[last], (m.size - last) * sizeof(uint32_t));
+                m.size -= last - i;
+                break;
+            }
+            case FUZZ_SET:
+                da_set(da, i, &value);
+                if (i < m.size) m.data[i] = value;
+                break;
+            case FUZZ_RESIZE: {
+                size_t n = value % FUZZ_MAX_ELEMS;
+                da_resize(da, n, &value);
+                for (size_t k = m.size; k < n; k++) m.data[k] = value;
+                m.size = n;
+                break;
+            }
+            case FUZZ_RESIZE_UNINITIALIZED: {
+                // New elements are uninitialized, so adopt whatever the array holds.
+                size_t n = value % FUZZ_MAX_ELEMS;
+                da_resize(da, n, NULL);
+                for (size_t k = m.size; k < n; k++) m.data[k] = *(uint32_t *)da_get(da, k);
+                m.size = n;
+                break;
+            }
+            case FUZZ_RESERVE:
+                da_reserve(da, value % (2 * FUZZ_MAX_ELEMS));
+                break;
+            case FUZZ_APPEND: {
+                size_t n = value % 64;
+                if (n > room) n = room;
+                for (size_t k = 0; k < n; k++) scratch[k] = value + (uint32_t)k;
+                da_append(da, scratch, n);
+                memcpy(&m.data[m.size], scratch, n * sizeof(uint32_t));
+                m.size += n;
+                break;
+            }
+            case FUZZ_CLEAR:
+                da_clear(da);
+                m.size = 0;
+                break;
+            case FUZZ_DUP: {
+                dynamic_array *dup = da_dup(da);
+                FUZZ_CHECK(dup);
+                fuzz_check_matches(dup, &m);
+                da_destroy(dup);
+                break;
+            }
+            case FUZZ_OP_COUNT:
+            default:
+                break;
+        }
+
+        fuzz_check_matches(da, &m);
+    }
+
+    da_destroy(da);
+    return 0;
+}
+
+#ifndef PYRAMID_LIBFUZZER
+
+/// @brief Run each file named on the command line (or standard input, if there are none) through
+/// the harness once. This lets the harness run under AFL, or replay a crashing input, without
+/// libFuzzer.
+int main(int argc, char **argv) {
+    for (int arg = 1; arg < argc || arg == 1; arg++) {
+        FILE *file = (arg < argc) ? fopen(argv[arg], "rb") : stdin;
+        if (!file) {
+            perror(argv[arg]);
+            return EXIT_FAILURE;
+        }
+
+        dynamic_array *input = da_create(sizeof(uint8_t));
+        uint8_t buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), file))) da_append(input, buf, n);
+        if (file != stdin) fclose(file);
+
+        LLVMFuzzerTestOneInput((const uint8_t *)da_data(input), da_size(input));
+        da_destroy(input);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#endif
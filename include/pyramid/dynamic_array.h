@@ -1,3 +1,5 @@
+#pragma once
+
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -62,11 +64,28 @@ void da_insert(dynamic_array *da, size_t i, const void *elem);
 /// pointed to by o_elem should be allocated by the caller.
 void da_erase(dynamic_array *da, size_t i, void *o_elem);
 
+/// @brief Erase the elements at indices [first, last) and, if o_elems is non-null, copy them into
+/// o_elems. Has no effect if the range is empty or out of bounds.
+/// @param da The dynamic array to be modified.
+/// @param first The index of the first element to be erased.
+/// @param last The index one past the last element to be erased.
+/// @param o_elems If not null, the elements that are removed from the dynamic array. The memory
+/// pointed to by o_elems should be allocated by the caller and must be large enough to hold
+/// last - first elements.
+void da_erase_range(dynamic_array *da, size_t first, size_t last, void *o_elems);
+
 /// @brief Push an element onto the end of the dynamic array.
 /// @param da The dynamic array to be modified.
 /// @param elem The element to add to the dynamic array.
 void da_push(dynamic_array *da, const void *elem);
 
+/// @brief Push the n elements stored contiguously at elems onto the end of the dynamic array. Has
+/// no effect if elems is NULL.
+/// @param da The dynamic array to be modified.
+/// @param elems The elements to add to the dynamic array.
+/// @param n The number of elements to add to the dynamic array.
+void da_append(dynamic_array *da, const void *elems, size_t n);
+
 /// @brief Pop an element from the end of the dynamic array and, if o_elem is non-null, copy it into
 /// o_elem.
 /// @param da The dynamic array to be modified.
@@ -82,7 +101,7 @@ void da_clear(dynamic_array *da);
 /// @param da The dynamic array to be modified.
 /// @param n The number of elements to be stored within the dynamic array.
 /// @param initial_value A pointer to the object to be used as the initial value for each new
-/// element within the dynamic array.
+/// element within the dynamic array. If NULL, the new elements are left uninitialized.
 void da_resize(dynamic_array *da, size_t n, const void *initial_value);
 
 /// @brief Reserve storage for at least n elements within the dynamic array.
@@ -121,6 +140,11 @@ size_t da_size(const dynamic_array *da);
 /// reallocation occurs.
 size_t da_capacity(const dynamic_array *da);
 
+/// @brief Return the size of the elements stored within the dynamic array, or 0 if da is NULL.
+/// @param da The dynamic array to be checked.
+/// @return The size of the elements stored within the dynamic array, or 0 if da is NULL.
+size_t da_elem_size(const dynamic_array *da);
+
 /// @brief Return the underlying array used as storage for the dynamic array, or NULL if no such
 /// storage exists.
 /// @param da The dynamic array to be accessed.
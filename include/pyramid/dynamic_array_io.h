@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pyramid/dynamic_array.h"
+
+/// @brief The number of bytes read from disk at a time by da_load.
+#define DA_IO_CHUNK_SIZE ((size_t)4 << 20)
+
+/// @brief The largest number of bytes a da_parse_function may leave unconsumed at the end of a
+/// chunk, i.e. the size of the largest record da_load can parse.
+#define DA_IO_CARRY_MAX ((size_t)1 << 20)
+
+/// @brief The value a da_parse_function returns to abort da_load, e.g. because a record is
+/// malformed or could not be added to the dynamic array.
+#define DA_IO_PARSE_ERROR SIZE_MAX
+
+/// @brief A function which parses the records in buf into the dynamic array da, returning the
+/// number of bytes it consumed. Any unconsumed bytes (e.g. a record that was cut off by the end of
+/// a chunk) are passed back at the start of buf on the next call, followed by the next chunk of the
+/// file. When eof is true, buf holds the end of the file and all of it must be consumed. Returning
+/// DA_IO_PARSE_ERROR makes da_load fail.
+typedef size_t (*da_parse_function)(dynamic_array *, const char *, size_t, bool, void *);
+
+/// @brief An in-progress flush of a dynamic array to disk.
+typedef struct da_flush_ctx da_flush;
+
+/// @brief Return an allocated dynamic array holding the contents of the file at path, or NULL if
+/// the file cannot be read or parsed, or the array cannot hold its contents. The file is read in
+/// chunks by a background thread into one buffer while the calling thread parses the other, so I/O
+/// and parsing overlap.
+/// @param path The path of the file to be loaded.
+/// @param elem_size The size of the structures being stored by the dynamic array.
+/// @param parse The function used to parse the file's contents into elements. If NULL, the file is
+/// treated as a packed array of elements, and its size must be a multiple of elem_size.
+/// @param arg An argument passed through to parse.
+/// @return An allocated dynamic array holding the contents of the file at path, or NULL if the file
+/// cannot be read or parsed, or the array cannot hold its contents.
+dynamic_array *da_load(const char *path, size_t elem_size, da_parse_function parse, void *arg);
+
+/// @brief Begin writing a snapshot of the elements within the dynamic array to the file at path as
+/// a packed array of elements, returning a handle to the flush or NULL if it cannot be started. The
+/// snapshot is a full copy of the array's elements, made on the calling thread before this function
+/// returns: it blocks for as long as a memcpy of the array takes and temporarily doubles the memory
+/// the array uses, until the background thread has written the copy out. In exchange, da may be
+/// modified or destroyed while the flush is in progress. Each flush writes to its own temporary
+/// file next to path, which atomically replaces the file at path once the snapshot is on disk, so
+/// concurrent flushes to the same path never mix their contents; the last one to finish wins. The
+/// rename is made durable by syncing the directory containing path.
+/// @param da The dynamic array to be flushed.
+/// @param path The path of the file to be written.
+/// @return A handle to the flush, or NULL if it cannot be started.
+da_flush *da_flush_async(const dynamic_array *da, const char *path);
+
+/// @brief Wait for a flush to finish and release the memory associated with it.
+/// @param flush The flush to be waited on.
+/// @return True if the snapshot was written to disk, and false otherwise.
+bool da_flush_wait(da_flush *flush);
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// @brief An array over a large index space in which few slots are expected to be populated.
+/// Storage is allocated in fixed-size pages on the first write to each page, and released once
+/// every slot in a page has been erased, so memory usage tracks the populated slots rather than the
+/// size of the index space.
+typedef struct sa_ctx sparse_array;
+
+/// @brief A snapshot of the memory used by a sparse array.
+typedef struct sa_stats {
+    /// @brief The number of populated slots.
+    size_t populated;
+    /// @brief The number of pages currently allocated.
+    size_t pages;
+    /// @brief The number of slots covered by the allocated pages.
+    size_t slots;
+    /// @brief The total number of bytes allocated for the sparse array, including bookkeeping.
+    size_t bytes;
+} sa_stats;
+
+/// @brief Return an allocated sparse array with n unpopulated slots which can store elements of
+/// size elem_size, or NULL if no such sparse array can be allocated. Only the page table is
+/// allocated up front; it costs one pointer per page of slots.
+/// @param elem_size The size of the structures being stored by this sparse array.
+/// @param n The number of slots within the sparse array.
+/// @return An allocated sparse array with n unpopulated slots which can store elements of size
+/// elem_size, or NULL if no such sparse array can be allocated.
+sparse_array *sa_create(size_t elem_size, size_t n);
+
+/// @brief Release the memory associated with a sparse array.
+/// @param sa The sparse array to be destroyed.
+void sa_destroy(sparse_array *sa);
+
+/// @brief Return a pointer to the element within the sparse array at index i, or NULL if i is out
+/// of bounds or the slot at index i is not populated.
+/// @param sa The sparse array to be accessed.
+/// @param i The index of the element to be retrieved.
+/// @return A pointer to the element within the sparse array at index i, or NULL if i is out of
+/// bounds or the slot at index i is not populated.
+void *sa_get(const sparse_array *sa, size_t i);
+
+/// @brief Populate the slot at index i with elem, allocating its page if necessary. Has no effect
+/// if i is out of bounds, elem is NULL, or the page cannot be allocated.
+/// @param sa The sparse array to be modified.
+/// @param i The index to populate.
+/// @param elem The element to store at index i.
+void sa_set(sparse_array *sa, size_t i, const void *elem);
+
+/// @brief Unpopulate the slot at index i and, if o_elem is non-null and the slot was populated,
+/// copy its element into o_elem. The page containing the slot is released if it becomes empty.
+/// @param sa The sparse array to be modified.
+/// @param i The index of the slot to unpopulate.
+/// @param o_elem If not null, the element that is removed from the sparse array. The memory pointed
+/// to by o_elem should be allocated by the caller.
+void sa_erase(sparse_array *sa, size_t i, void *o_elem);
+
+/// @brief Unpopulate every slot within the sparse array and release all of its pages.
+/// @param sa The sparse array to be modified.
+void sa_clear(sparse_array *sa);
+
+/// @brief Return true if the slot at index i is populated, and false otherwise.
+/// @param sa The sparse array to be checked.
+/// @param i The index of the slot to be checked.
+/// @return True if the slot at index i is populated, and false otherwise.
+bool sa_contains(const sparse_array *sa, size_t i);
+
+/// @brief Return the index of the first populated slot at or after index i, or sa_size(sa) if there
+/// is none. Unallocated pages and empty bitmap words are skipped wholesale, so iterating with
+///
+///     for (size_t i = sa_next(sa, 0); i < sa_size(sa); i = sa_next(sa, i + 1))
+///
+/// visits every populated slot in order at a cost of one pointer check per unallocated page.
+/// @param sa The sparse array to be searched.
+/// @param i The index to start searching from.
+/// @return The index of the first populated slot at or after index i, or sa_size(sa) if there is
+/// none.
+size_t sa_next(const sparse_array *sa, size_t i);
+
+/// @brief Return the number of slots within the sparse array, populated or not.
+/// @param sa The sparse array to be checked.
+/// @return The number of slots within the sparse array.
+size_t sa_size(const sparse_array *sa);
+
+/// @brief Return the number of populated slots within the sparse array.
+/// @param sa The sparse array to be checked.
+/// @return The number of populated slots within the sparse array.
+size_t sa_count(const sparse_array *sa);
+
+/// @brief Write a snapshot of the memory used by the sparse array into o_stats. If sa is NULL, all
+/// statistics are zero.
+/// @param sa The sparse array to be checked.
+/// @param o_stats The memory statistics of the sparse array. The memory pointed to by o_stats
+/// should be allocated by the caller.
+void sa_get_stats(const sparse_array *sa, sa_stats *o_stats);
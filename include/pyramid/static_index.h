@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "pyramid/dynamic_array.h"
+
+/// @brief A read-only search index over a sorted set of keys. Keys are stored in Eytzinger (BFS)
+/// order so that the first levels of every search share a handful of cache lines and the next
+/// levels can be prefetched ahead of the comparisons that need them.
+typedef struct si_ctx static_index;
+
+/// @brief A function which returns a negative value, zero, or a positive value if the key pointed
+/// to by the first argument is less than, equal to, or greater than the key pointed to by the
+/// second argument, respectively (i.e. the same contract as a qsort comparator).
+typedef int (*si_compare_function)(const void *, const void *);
+
+/// @brief Return an allocated static index over the keys stored in the dynamic array keys, or NULL
+/// if no such static index can be allocated. The keys are copied, so keys may be modified or
+/// destroyed afterwards without affecting the index.
+/// @param keys A dynamic array of keys, sorted in ascending order according to cmp.
+/// @param cmp The function used to compare keys.
+/// @return An allocated static index over the keys stored in keys, or NULL if no such static index
+/// can be allocated.
+static_index *si_create(const dynamic_array *keys, si_compare_function cmp);
+
+/// @brief Release the memory associated with a static index.
+/// @param si The static index to be destroyed.
+void si_destroy(static_index *si);
+
+/// @brief Replace the contents of the static index with the keys stored in the dynamic array keys,
+/// reusing the existing storage where possible. The keys must have the same element size as those
+/// the index was created with. If storage for the new keys cannot be allocated, the index is left
+/// empty.
+/// @param si The static index to be rebuilt.
+/// @param keys A dynamic array of keys, sorted in ascending order.
+/// @return True if the index was rebuilt, and false otherwise.
+bool si_rebuild(static_index *si, const dynamic_array *keys);
+
+/// @brief Return the index (within the sorted keys the static index was built from) of the first
+/// key which is not less than key, or si_size(si) if no such key exists.
+/// @param si The static index to be searched.
+/// @param key The key to search for.
+/// @return The index of the first key which is not less than key, or si_size(si) if no such key
+/// exists.
+size_t si_lower_bound(const static_index *si, const void *key);
+
+/// @brief Return the index (within the sorted keys the static index was built from) of a key which
+/// is equal to key, or si_size(si) if no such key exists.
+/// @param si The static index to be searched.
+/// @param key The key to search for.
+/// @return The index of a key which is equal to key, or si_size(si) if no such key exists.
+size_t si_find(const static_index *si, const void *key);
+
+/// @brief Perform si_lower_bound for each of the n keys stored contiguously at keys, writing the
+/// results to o_indices. Searches are interleaved so that the memory latency of one search is
+/// hidden behind the comparisons of the others, which makes this considerably faster than n calls
+/// to si_lower_bound when the index does not fit in cache.
+/// @param si The static index to be searched.
+/// @param keys A pointer to n keys, each of the element size the index was built with.
+/// @param n The number of keys to search for.
+/// @param o_indices The results of each search. The memory pointed to by o_indices should be
+/// allocated by the caller and must be large enough to hold n indices.
+void si_lower_bound_batch(const static_index *si, const void *keys, size_t n, size_t *o_indices);
+
+/// @brief Return the number of keys stored within the static index.
+/// @param si The static index to be checked.
+/// @return The number of keys stored within the static index.
+size_t si_size(const static_index *si);
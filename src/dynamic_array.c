@@ -1,6 +1,7 @@
 #include "pyramid/dynamic_array.h"
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,11 +20,38 @@ struct da_ctx {
 /// @brief Reallocate the memory associated with a dynamic array.
 /// @param da The dynamic array to be reallocated.
 /// @param new_capacity The new capacity of the dynamic array.
-static void da_realloc(dynamic_array *da, size_t new_capacity) {
+/// @return True if the memory was reallocated, and false otherwise. On failure, the dynamic array
+/// is left unchanged.
+static bool da_realloc(dynamic_array *da, size_t new_capacity) {
     assert(da);
 
+    if (new_capacity > SIZE_MAX / da->elem_size) return false;
+
+    char *data = (char *)realloc(da->data, new_capacity * da->elem_size);
+    if (!data) return false;
+
     da->capacity = new_capacity;
-    da->data     = (char *)realloc(da->data, da->capacity * da->elem_size);
+    da->data     = data;
+    return true;
+}
+
+/// @brief Grow the capacity of a dynamic array geometrically until it can hold at least n elements.
+/// @param da The dynamic array to be grown.
+/// @param n The number of elements the dynamic array must be able to hold.
+/// @return True if the dynamic array can hold n elements, and false otherwise. On failure, the
+/// dynamic array is left unchanged.
+static bool da_grow(dynamic_array *da, size_t n) {
+    assert(da);
+
+    if (n <= da->capacity) return true;
+
+    size_t new_capacity = (da->capacity) ? da->capacity : 1;
+    while (new_capacity < n) {
+        if (new_capacity > SIZE_MAX / 2) return da_realloc(da, n);
+        new_capacity *= 2;
+    }
+
+    return da_realloc(da, new_capacity);
 }
 
 dynamic_array *da_create(size_t elem_size) {
@@ -47,7 +75,11 @@ dynamic_array *da_create_n(size_t elem_size, size_t n, const void *initial_value
     if (!da) return NULL;
     if (!n) return da;
 
-    da_realloc(da, n);
+    if (!da_realloc(da, n)) {
+        da_destroy(da);
+        return NULL;
+    }
+
     da->size = n;
 
     if (initial_value) {
@@ -65,9 +97,13 @@ dynamic_array *da_dup(const dynamic_array *other) {
     dynamic_array *da = da_create(other->elem_size);
     if (!da) return NULL;
 
-    da_reserve(da, other->capacity);
+    if (other->capacity && !da_realloc(da, other->capacity)) {
+        da_destroy(da);
+        return NULL;
+    }
+
     da->size = other->size;
-    memcpy(da->data, other->data, other->size * other->elem_size);
+    if (other->size) memcpy(da->data, other->data, other->size * other->elem_size);
 
     return da;
 }
@@ -95,7 +131,7 @@ void da_set(dynamic_array *da, size_t i, const void *elem) {
 void da_insert(dynamic_array *da, size_t i, const void *elem) {
     if (!da || i > da->size || !elem) return;
 
-    if (da->size == da->capacity) da_realloc(da, (da->capacity) ? da->capacity * 2 : 1);
+    if (!da_grow(da, da->size + 1)) return;
 
     // Shift all elements after i to the right by one.
     char *dest = DA_PTR_FROM_IDX(da, i);
@@ -118,16 +154,40 @@ void da_erase(dynamic_array *da, size_t i, void *o_elem) {
     da->size--;
 }
 
+void da_erase_range(dynamic_array *da, size_t first, size_t last, void *o_elems) {
+    if (da_is_empty(da) || first >= last || last > da->size) return;
+
+    char *dest  = DA_PTR_FROM_IDX(da, first);
+    char *src   = DA_PTR_FROM_IDX(da, last);
+    size_t span = (last - first) * da->elem_size;
+
+    if (o_elems) memmove(o_elems, dest, span);
+
+    // Shift all elements after the range to the left by the length of the range, in one move.
+    memmove(dest, src, (da->size - last) * da->elem_size);
+
+    da->size -= last - first;
+}
+
 void da_push(dynamic_array *da, const void *elem) {
     if (!da || !elem) return;
 
-    if (da->size == da->capacity) da_realloc(da, (da->capacity) ? da->capacity * 2 : 1);
+    if (!da_grow(da, da->size + 1)) return;
 
     char *dest = DA_PTR_FROM_IDX(da, da->size);
     memmove(dest, elem, da->elem_size);
     da->size++;
 }
 
+void da_append(dynamic_array *da, const void *elems, size_t n) {
+    if (!da || !elems || !n || n > SIZE_MAX - da->size) return;
+
+    if (!da_grow(da, da->size + n)) return;
+
+    memcpy(DA_PTR_FROM_IDX(da, da->size), elems, n * da->elem_size);
+    da->size += n;
+}
+
 void da_pop(dynamic_array *da, void *o_elem) {
     if (da_is_empty(da)) return;
 
@@ -145,9 +205,9 @@ void da_clear(dynamic_array *da) {
 void da_resize(dynamic_array *da, size_t n, const void *initial_value) {
     if (!da) return;
 
-    if (n > da->capacity) da_realloc(da, n);
+    if (n > da->capacity && !da_realloc(da, n)) return;
 
-    if (n > da->size) {
+    if (n > da->size && initial_value) {
         for (size_t i = da->size; i < n; i++) {
             memcpy(DA_PTR_FROM_IDX(da, i), initial_value, da->elem_size);
         }
@@ -189,3 +249,7 @@ size_t da_size(const dynamic_array *da) {
 size_t da_capacity(const dynamic_array *da) {
     return da ? da->capacity : 0;
 }
+
+size_t da_elem_size(const dynamic_array *da) {
+    return da ? da->elem_size : 0;
+}
@@ -0,0 +1,339 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "pyramid/dynamic_array_io.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @brief The suffix of the temporary files flushes write to before replacing their destination,
+/// completed by mkstemp so that every flush gets a file of its own.
+#define DA_IO_TMP_SUFFIX ".XXXXXX"
+
+/// @brief Calculate the address of the region of buffer b that the reader thread fills. The
+/// DA_IO_CARRY_MAX bytes before it are reserved for bytes carried over from the previous chunk.
+#define DA_IO_CHUNK(b) ((b)->data + DA_IO_CARRY_MAX)
+
+/// @brief The owner of one of the buffers shared between da_load and its reader thread.
+enum da_io_buffer_state {
+    DA_IO_EMPTY,  // Owned by the reader thread, which is (or will be) filling it.
+    DA_IO_FULL,   // Owned by da_load, which is (or will be) parsing it.
+};
+
+/// @brief A buffer shared between da_load and its reader thread. A buffer holding fewer than
+/// DA_IO_CHUNK_SIZE bytes holds the end of the file.
+struct da_io_buffer {
+    char *data;
+    size_t len;
+    enum da_io_buffer_state state;
+    int error;
+};
+
+/// @brief A structure containing the state shared between da_load and its reader thread.
+struct da_io_reader {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    struct da_io_buffer buffers[2];
+    int fd;
+    int cancelled;
+};
+
+/// @brief A structure containing information about a particular flush.
+struct da_flush_ctx {
+    pthread_t thread;
+    char *path;
+    char *tmp_path;
+    char *data;
+    size_t len;
+    int fd;
+    int error;
+};
+
+/// @brief Fill the buffers of a reader with consecutive chunks of its file, alternating between
+/// them, until the end of the file is reached, a read fails, or the reader is cancelled.
+/// @param arg The reader.
+/// @return NULL.
+static void *da_io_read_loop(void *arg) {
+    struct da_io_reader *r = (struct da_io_reader *)arg;
+    off_t offset           = 0;
+
+    for (size_t i = 0;; i ^= 1) {
+        struct da_io_buffer *b = &r->buffers[i];
+
+        pthread_mutex_lock(&r->lock);
+        while (b->state != DA_IO_EMPTY && !r->cancelled) pthread_cond_wait(&r->cond, &r->lock);
+        int cancelled = r->cancelled;
+        pthread_mutex_unlock(&r->lock);
+
+        if (cancelled) return NULL;
+
+        size_t len = 0;
+        int error  = 0;
+        while (len < DA_IO_CHUNK_SIZE) {
+            ssize_t n = pread(r->fd, DA_IO_CHUNK(b) + len, DA_IO_CHUNK_SIZE - len, offset);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                error = (n < 0) ? errno : 0;
+                break;
+            }
+
+            len += (size_t)n;
+            offset += n;
+        }
+
+        pthread_mutex_lock(&r->lock);
+        b->len   = len;
+        b->error = error;
+        b->state = DA_IO_FULL;
+        pthread_cond_broadcast(&r->cond);
+        pthread_mutex_unlock(&r->lock);
+
+        if (len < DA_IO_CHUNK_SIZE || error) return NULL;
+    }
+}
+
+/// @brief Parse a packed array of elements into a dynamic array.
+static size_t da_io_parse_raw(dynamic_array *da, const char *buf, size_t len, bool eof, void *arg) {
+    (void)eof;
+    (void)arg;
+
+    size_t n    = len / da_elem_size(da);
+    size_t size = da_size(da);
+    da_append(da, buf, n);
+
+    // da_append has no effect if the array cannot grow to hold the elements.
+    if (da_size(da) != size + n) return DA_IO_PARSE_ERROR;
+
+    return n * da_elem_size(da);
+}
+
+dynamic_array *da_load(const char *path, size_t elem_size, da_parse_function parse, void *arg) {
+    if (!path || !elem_size) return NULL;
+
+    dynamic_array *da = da_create(elem_size);
+    if (!da) return NULL;
+
+    struct da_io_reader r;
+    r.fd        = open(path, O_RDONLY);
+    r.cancelled = 0;
+    for (size_t i = 0; i < 2; i++) {
+        r.buffers[i].state = DA_IO_EMPTY;
+        r.buffers[i].data  = (char *)malloc(DA_IO_CARRY_MAX + DA_IO_CHUNK_SIZE);
+    }
+
+    if (r.fd < 0 || !r.buffers[0].data || !r.buffers[1].data) goto fail;
+
+    posix_fadvise(r.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Packed files map directly onto elements, so their final size is known up front, and there is
+    // no point in reading the file if the array cannot hold it.
+    if (!parse) {
+        struct stat st;
+        if (!fstat(r.fd, &st) && st.st_size > 0) {
+            size_t n = (size_t)st.st_size / elem_size;
+            da_reserve(da, n);
+            if (da_capacity(da) < n) goto fail;
+        }
+        parse = da_io_parse_raw;
+    }
+
+    pthread_mutex_init(&r.lock, NULL);
+    pthread_cond_init(&r.cond, NULL);
+
+    pthread_t reader;
+    if (pthread_create(&reader, NULL, da_io_read_loop, &r)) {
+        pthread_cond_destroy(&r.cond);
+        pthread_mutex_destroy(&r.lock);
+        goto fail;
+    }
+
+    bool ok      = true;
+    size_t carry = 0;
+    for (size_t i = 0;; i ^= 1) {
+        struct da_io_buffer *b = &r.buffers[i];
+
+        pthread_mutex_lock(&r.lock);
+        while (b->state != DA_IO_FULL) pthread_cond_wait(&r.cond, &r.lock);
+        pthread_mutex_unlock(&r.lock);
+
+        if (b->error) {
+            ok = false;
+            break;
+        }
+
+        // Bytes left over from the previous chunk were copied into this buffer's reserved region,
+        // directly in front of the bytes that follow them in the file.
+        bool eof    = (b->len < DA_IO_CHUNK_SIZE);
+        char *start = DA_IO_CHUNK(b) - carry;
+        size_t len  = carry + b->len;
+        size_t used = parse(da, start, len, eof, arg);
+        if (used == DA_IO_PARSE_ERROR) {
+            ok = false;
+            break;
+        }
+        if (used > len) used = len;
+
+        carry = len - used;
+        if (eof) {
+            ok = !carry;
+            break;
+        }
+        if (carry > DA_IO_CARRY_MAX) {
+            ok = false;
+            break;
+        }
+
+        // The reader thread may already be filling the other buffer, but never touches its
+        // reserved region.
+        memcpy(DA_IO_CHUNK(&r.buffers[i ^ 1]) - carry, start + used, carry);
+
+        pthread_mutex_lock(&r.lock);
+        b->state = DA_IO_EMPTY;
+        pthread_cond_broadcast(&r.cond);
+        pthread_mutex_unlock(&r.lock);
+    }
+
+    pthread_mutex_lock(&r.lock);
+    r.cancelled = 1;
+    pthread_cond_broadcast(&r.cond);
+    pthread_mutex_unlock(&r.lock);
+
+    pthread_join(reader, NULL);
+    pthread_cond_destroy(&r.cond);
+    pthread_mutex_destroy(&r.lock);
+
+    if (!ok) goto fail;
+
+    close(r.fd);
+    free(r.buffers[0].data);
+    free(r.buffers[1].data);
+
+    return da;
+
+fail:
+    if (r.fd >= 0) close(r.fd);
+    free(r.buffers[0].data);
+    free(r.buffers[1].data);
+    da_destroy(da);
+
+    return NULL;
+}
+
+/// @brief Flush the directory containing the file at path to disk, so that a rename into it
+/// survives a crash.
+/// @param path The path of a file within the directory.
+/// @return Zero on success, or an errno value on failure.
+static int da_io_sync_parent(const char *path) {
+    // Naming the directory "<everything up to the last slash>." covers "/b", "a/b" and "b" alike.
+    const char *slash = strrchr(path, '/');
+    size_t len        = slash ? (size_t)(slash - path) + 1 : 0;
+    char *dir         = (char *)malloc(len + 2);
+    if (!dir) return ENOMEM;
+
+    memcpy(dir, path, len);
+    memcpy(dir + len, ".", 2);
+
+    int error = 0;
+    int fd    = open(dir, O_RDONLY | O_DIRECTORY);
+    if (fd < 0 || fsync(fd)) error = errno;
+    if (fd >= 0) close(fd);
+    free(dir);
+
+    return error;
+}
+
+/// @brief Write the snapshot held by a flush to its temporary file, then move it into place.
+/// @param arg The flush.
+/// @return NULL.
+static void *da_io_write_loop(void *arg) {
+    da_flush *f = (da_flush *)arg;
+
+    size_t done = 0;
+    while (done < f->len) {
+        ssize_t n = write(f->fd, f->data + done, f->len - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            f->error = (n < 0) ? errno : EIO;
+            break;
+        }
+
+        done += (size_t)n;
+    }
+
+    // The snapshot is no longer needed once it has been handed to the kernel.
+    free(f->data);
+    f->data = NULL;
+
+    if (!f->error && fsync(f->fd)) f->error = errno;
+    if (close(f->fd) && !f->error) f->error = errno;
+    if (!f->error && rename(f->tmp_path, f->path)) f->error = errno;
+    if (f->error) unlink(f->tmp_path);
+    if (!f->error) f->error = da_io_sync_parent(f->path);
+
+    return NULL;
+}
+
+da_flush *da_flush_async(const dynamic_array *da, const char *path) {
+    if (!da || !path) return NULL;
+
+    da_flush *f = (da_flush *)malloc(sizeof(da_flush));
+    if (!f) return NULL;
+
+    size_t path_len = strlen(path);
+    f->path         = (char *)malloc(path_len + 1);
+    f->tmp_path     = (char *)malloc(path_len + sizeof(DA_IO_TMP_SUFFIX));
+    f->len          = da_size(da) * da_elem_size(da);
+    f->data         = (char *)malloc(f->len ? f->len : 1);
+    f->fd           = -1;
+    f->error        = 0;
+
+    if (!f->path || !f->tmp_path || !f->data) goto fail;
+
+    memcpy(f->path, path, path_len + 1);
+    memcpy(f->tmp_path, path, path_len);
+    memcpy(f->tmp_path + path_len, DA_IO_TMP_SUFFIX, sizeof(DA_IO_TMP_SUFFIX));
+
+    // Create the temporary file up front so that an unwritable destination is reported before any
+    // copying is done. mkstemp creates it readable by its owner only, so widen it to the mode the
+    // destination would have been created with.
+    f->fd = mkstemp(f->tmp_path);
+    if (f->fd < 0) goto fail;
+    fchmod(f->fd, 0644);
+
+    if (f->len) memcpy(f->data, da_data(da), f->len);
+
+    if (pthread_create(&f->thread, NULL, da_io_write_loop, f)) goto fail;
+
+    return f;
+
+fail:
+    if (f->fd >= 0) {
+        close(f->fd);
+        unlink(f->tmp_path);
+    }
+    free(f->path);
+    free(f->tmp_path);
+    free(f->data);
+    free(f);
+
+    return NULL;
+}
+
+bool da_flush_wait(da_flush *flush) {
+    if (!flush) return false;
+
+    pthread_join(flush->thread, NULL);
+    bool ok = !flush->error;
+
+    free(flush->path);
+    free(flush->tmp_path);
+    free(flush->data);
+    free(flush);
+
+    return ok;
+}
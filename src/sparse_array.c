@@ -0,0 +1,218 @@
+#include "pyramid/sparse_array.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The base-2 logarithm of the number of slots in a page.
+#define SA_PAGE_SHIFT 10
+
+/// @brief The number of slots in a page.
+#define SA_PAGE_SLOTS ((size_t)1 << SA_PAGE_SHIFT)
+
+/// @brief The number of 64-bit words in the presence bitmap of a page.
+#define SA_PAGE_WORDS (SA_PAGE_SLOTS / 64)
+
+/// @brief The number of bytes of padding needed after the count and presence bitmap of a page for
+/// its slots to be aligned for any element type. Never zero, so that it can size an array.
+#define SA_PAGE_PADDING   \
+    (alignof(max_align_t) \
+     - (sizeof(size_t) + SA_PAGE_WORDS * sizeof(uint64_t)) % alignof(max_align_t))
+
+/// @brief Calculate the address of the j'th slot in page p of sparse array s.
+#define SA_PTR_FROM_IDX(s, p, j) ((p)->data + ((j) * (s)->elem_size))
+
+/// @brief A lazily allocated page of slots. Bit j of the presence bitmap is set if slot j is
+/// populated.
+struct sa_page {
+    size_t count;
+    uint64_t present[SA_PAGE_WORDS];
+    char padding[SA_PAGE_PADDING];
+    alignas(max_align_t) char data[];
+};
+
+/// @brief A structure containing information about a particular sparse array.
+struct sa_ctx {
+    size_t size;
+    size_t count;
+    size_t elem_size;
+    size_t page_count;
+    size_t pages_allocated;
+    struct sa_page **pages;
+};
+
+/// @brief Return the index of the lowest set bit of a non-zero word.
+static size_t sa_lowest_bit(uint64_t word) {
+    assert(word);
+
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(word);
+#else
+    size_t n = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/// @brief Return the number of bytes occupied by a page of a sparse array.
+static size_t sa_page_bytes(const sparse_array *sa) {
+    return sizeof(struct sa_page) + SA_PAGE_SLOTS * sa->elem_size;
+}
+
+/// @brief Release one of the pages of a sparse array, if it is allocated.
+/// @param sa The sparse array to be modified.
+/// @param p The index of the page to be released.
+static void sa_release_page(sparse_array *sa, size_t p) {
+    assert(sa && p < sa->page_count);
+
+    if (!sa->pages[p]) return;
+
+    sa->count -= sa->pages[p]->count;
+    sa->pages_allocated--;
+
+    free(sa->pages[p]);
+    sa->pages[p] = NULL;
+}
+
+sparse_array *sa_create(size_t elem_size, size_t n) {
+    if (!elem_size || elem_size > (SIZE_MAX - sizeof(struct sa_page)) / SA_PAGE_SLOTS) return NULL;
+
+    sparse_array *sa = (sparse_array *)malloc(sizeof(sparse_array));
+    if (!sa) return NULL;
+
+    sa->size            = n;
+    sa->count           = 0;
+    sa->elem_size       = elem_size;
+    sa->page_count      = (n >> SA_PAGE_SHIFT) + ((n & (SA_PAGE_SLOTS - 1)) ? 1 : 0);
+    sa->pages_allocated = 0;
+    sa->pages           = NULL;
+
+    if (sa->page_count) {
+        sa->pages = (struct sa_page **)calloc(sa->page_count, sizeof(struct sa_page *));
+        if (!sa->pages) {
+            free(sa);
+            return NULL;
+        }
+    }
+
+    return sa;
+}
+
+void sa_destroy(sparse_array *sa) {
+    if (!sa) return;
+
+    sa_clear(sa);
+    free(sa->pages);
+
+    free(sa);
+}
+
+void *sa_get(const sparse_array *sa, size_t i) {
+    if (!sa || i >= sa->size) return NULL;
+
+    struct sa_page *page = sa->pages[i >> SA_PAGE_SHIFT];
+    size_t j             = i & (SA_PAGE_SLOTS - 1);
+    if (!page || !(page->present[j / 64] & ((uint64_t)1 << (j % 64)))) return NULL;
+
+    return SA_PTR_FROM_IDX(sa, page, j);
+}
+
+void sa_set(sparse_array *sa, size_t i, const void *elem) {
+    if (!sa || i >= sa->size || !elem) return;
+
+    struct sa_page **slot = &sa->pages[i >> SA_PAGE_SHIFT];
+    if (!*slot) {
+        // Only the header is zeroed; slot storage is written before it is ever read.
+        struct sa_page *page = (struct sa_page *)malloc(sa_page_bytes(sa));
+        if (!page) return;
+
+        memset(page, 0, sizeof(struct sa_page));
+        *slot = page;
+        sa->pages_allocated++;
+    }
+
+    struct sa_page *page = *slot;
+    size_t j             = i & (SA_PAGE_SLOTS - 1);
+    uint64_t bit         = (uint64_t)1 << (j % 64);
+
+    if (!(page->present[j / 64] & bit)) {
+        page->present[j / 64] |= bit;
+        page->count++;
+        sa->count++;
+    }
+
+    memcpy(SA_PTR_FROM_IDX(sa, page, j), elem, sa->elem_size);
+}
+
+void sa_erase(sparse_array *sa, size_t i, void *o_elem) {
+    if (!sa || i >= sa->size) return;
+
+    struct sa_page *page = sa->pages[i >> SA_PAGE_SHIFT];
+    size_t j             = i & (SA_PAGE_SLOTS - 1);
+    uint64_t bit         = (uint64_t)1 << (j % 64);
+    if (!page || !(page->present[j / 64] & bit)) return;
+
+    if (o_elem) memcpy(o_elem, SA_PTR_FROM_IDX(sa, page, j), sa->elem_size);
+
+    page->present[j / 64] &= ~bit;
+    page->count--;
+    sa->count--;
+
+    if (!page->count) sa_release_page(sa, i >> SA_PAGE_SHIFT);
+}
+
+void sa_clear(sparse_array *sa) {
+    if (!sa) return;
+
+    for (size_t p = 0; p < sa->page_count && sa->pages_allocated; p++) sa_release_page(sa, p);
+}
+
+bool sa_contains(const sparse_array *sa, size_t i) {
+    return sa_get(sa, i) != NULL;
+}
+
+size_t sa_next(const sparse_array *sa, size_t i) {
+    if (!sa || i >= sa->size) return sa_size(sa);
+
+    for (size_t p = i >> SA_PAGE_SHIFT; p < sa->page_count; p++) {
+        const struct sa_page *page = sa->pages[p];
+        if (!page) continue;
+
+        // Only the first page searched can start partway through.
+        size_t start = (p == (i >> SA_PAGE_SHIFT)) ? (i & (SA_PAGE_SLOTS - 1)) : 0;
+
+        for (size_t w = start / 64; w < SA_PAGE_WORDS; w++) {
+            uint64_t word = page->present[w];
+            if (w == start / 64) word &= ~(uint64_t)0 << (start % 64);
+            if (word) return (p << SA_PAGE_SHIFT) + w * 64 + sa_lowest_bit(word);
+        }
+    }
+
+    return sa->size;
+}
+
+size_t sa_size(const sparse_array *sa) {
+    return sa ? sa->size : 0;
+}
+
+size_t sa_count(const sparse_array *sa) {
+    return sa ? sa->count : 0;
+}
+
+void sa_get_stats(const sparse_array *sa, sa_stats *o_stats) {
+    if (!o_stats) return;
+
+    memset(o_stats, 0, sizeof(sa_stats));
+    if (!sa) return;
+
+    o_stats->populated = sa->count;
+    o_stats->pages     = sa->pages_allocated;
+    o_stats->slots     = sa->pages_allocated * SA_PAGE_SLOTS;
+    o_stats->bytes     = sizeof(sparse_array) + sa->page_count * sizeof(struct sa_page *)
+                       + sa->pages_allocated * sa_page_bytes(sa);
+}
@@ -0,0 +1,233 @@
+#include "pyramid/static_index.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The size, in bytes, of the cache lines the layout of a static index is tuned for.
+#define SI_CACHE_LINE 64
+
+/// @brief The number of searches that si_lower_bound_batch advances in lockstep.
+#define SI_BATCH_LANES 16
+
+/// @brief Calculate the address of the k'th key (in Eytzinger order) in static index s.
+#define SI_PTR_FROM_IDX(s, k) ((s)->data + ((k) * (s)->elem_size))
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SI_PREFETCH(p) __builtin_prefetch((p))
+#else
+#define SI_PREFETCH(p) ((void)(p))
+#endif
+
+/// @brief A structure containing information about a particular static index.
+///
+/// Keys are stored 1-indexed in Eytzinger order: the children of the key at position k are at
+/// positions 2k and 2k + 1. Position 0 is unused, which keeps the descendants of k that are
+/// prefetch_shift levels down in one contiguous (and, for power-of-two key sizes, cache-line
+/// aligned) block.
+struct si_ctx {
+    size_t size;
+    size_t capacity;
+    size_t elem_size;
+    size_t prefetch_shift;
+    si_compare_function cmp;
+    char *data;
+    size_t *rank;
+};
+
+/// @brief Return the number of consecutive set bits at the bottom of k.
+static size_t si_trailing_ones(size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (~k) ? (size_t)__builtin_ctzll((unsigned long long)~k) : sizeof(k) * 8;
+#else
+    size_t n = 0;
+    while (k & 1) {
+        k >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/// @brief Map the final position of a descent through a static index to the position of the key
+/// the descent was looking for, or 0 if the descent fell off the right edge of the tree.
+static inline size_t si_resolve(size_t k) {
+    // The descent went left once at the answer and then right at every level below it; strip those
+    // right turns and the left turn to recover the answer's position.
+    return k >> (si_trailing_ones(k) + 1);
+}
+
+/// @brief Prefetch the block of descendants of the key at position k, if that block exists.
+static inline void si_prefetch_descendants(const static_index *si, size_t k) {
+    size_t d = k << si->prefetch_shift;
+    if (d <= si->size) SI_PREFETCH(SI_PTR_FROM_IDX(si, d));
+}
+
+/// @brief Return the position of the first key in a static index which is not less than key, or 0
+/// if no such key exists.
+static inline size_t si_descend(const static_index *si, const void *key) {
+    size_t k = 1;
+    while (k <= si->size) {
+        si_prefetch_descendants(si, k);
+        k = 2 * k + (si->cmp(SI_PTR_FROM_IDX(si, k), key) < 0);
+    }
+
+    return si_resolve(k);
+}
+
+/// @brief Reallocate the storage associated with a static index.
+/// @param si The static index to be reallocated.
+/// @param new_capacity The new capacity of the static index.
+/// @return True if the storage was reallocated, and false otherwise.
+static bool si_realloc(static_index *si, size_t new_capacity) {
+    assert(si);
+
+    free(si->data);
+    free(si->rank);
+    si->data     = NULL;
+    si->rank     = NULL;
+    si->capacity = 0;
+
+    // Position 0 is unused, so one extra slot is needed.
+    size_t slots = new_capacity + 1;
+    if (slots > SIZE_MAX / si->elem_size || slots > SIZE_MAX / sizeof(size_t)) return false;
+
+    size_t bytes = slots * si->elem_size;
+    bytes        = (bytes + SI_CACHE_LINE - 1) / SI_CACHE_LINE * SI_CACHE_LINE;
+
+    si->data = (char *)aligned_alloc(SI_CACHE_LINE, bytes);
+    si->rank = (size_t *)malloc(slots * sizeof(size_t));
+    if (!si->data || !si->rank) {
+        free(si->data);
+        free(si->rank);
+        si->data = NULL;
+        si->rank = NULL;
+        return false;
+    }
+
+    si->capacity = new_capacity;
+    return true;
+}
+
+/// @brief Copy sorted keys into the subtree of a static index rooted at position k.
+/// @param si The static index to be filled.
+/// @param src The sorted keys.
+/// @param i The index of the next sorted key to be copied.
+/// @param k The position of the root of the subtree to be filled.
+static void si_fill(static_index *si, const char *src, size_t *i, size_t k) {
+    if (k > si->size) return;
+
+    si_fill(si, src, i, 2 * k);
+
+    memcpy(SI_PTR_FROM_IDX(si, k), src + (*i * si->elem_size), si->elem_size);
+    si->rank[k] = (*i)++;
+
+    si_fill(si, src, i, 2 * k + 1);
+}
+
+static_index *si_create(const dynamic_array *keys, si_compare_function cmp) {
+    if (!keys || !cmp) return NULL;
+
+    static_index *si = (static_index *)malloc(sizeof(static_index));
+    if (!si) return NULL;
+
+    si->size           = 0;
+    si->capacity       = 0;
+    si->elem_size      = da_elem_size(keys);
+    si->prefetch_shift = 1;
+    si->cmp            = cmp;
+    si->data           = NULL;
+    si->rank           = NULL;
+
+    // Prefetch as many levels ahead as fit in one cache line, but always at least one.
+    while (((size_t)2 << si->prefetch_shift) * si->elem_size <= SI_CACHE_LINE) {
+        si->prefetch_shift++;
+    }
+
+    if (!si_rebuild(si, keys)) {
+        si_destroy(si);
+        return NULL;
+    }
+
+    return si;
+}
+
+void si_destroy(static_index *si) {
+    if (!si) return;
+
+    free(si->data);
+    free(si->rank);
+
+    free(si);
+}
+
+bool si_rebuild(static_index *si, const dynamic_array *keys) {
+    if (!si || !keys || da_elem_size(keys) != si->elem_size) return false;
+
+    size_t n = da_size(keys);
+    if (n > si->capacity && !si_realloc(si, n)) {
+        si->size = 0;
+        return false;
+    }
+
+    si->size = n;
+
+    size_t i = 0;
+    si_fill(si, (const char *)da_data(keys), &i, 1);
+
+    return true;
+}
+
+size_t si_lower_bound(const static_index *si, const void *key) {
+    if (!si || !key) return si_size(si);
+
+    size_t k = si_descend(si, key);
+
+    return k ? si->rank[k] : si->size;
+}
+
+size_t si_find(const static_index *si, const void *key) {
+    if (!si || !key) return si_size(si);
+
+    size_t k = si_descend(si, key);
+
+    return (k && !si->cmp(SI_PTR_FROM_IDX(si, k), key)) ? si->rank[k] : si->size;
+}
+
+void si_lower_bound_batch(const static_index *si, const void *keys, size_t n, size_t *o_indices) {
+    if (!si || !keys || !o_indices) return;
+
+    const char *src = (const char *)keys;
+
+    // Every search takes either floor(log2(size)) + 1 steps or one fewer, so running each group of
+    // searches for that many steps finishes all of them.
+    size_t depth = 0;
+    for (size_t s = si->size; s; s >>= 1) depth++;
+
+    for (size_t base = 0; base < n; base += SI_BATCH_LANES) {
+        size_t lanes = (n - base < SI_BATCH_LANES) ? n - base : SI_BATCH_LANES;
+        size_t k[SI_BATCH_LANES];
+
+        for (size_t l = 0; l < lanes; l++) k[l] = 1;
+
+        for (size_t d = 0; d < depth; d++) {
+            for (size_t l = 0; l < lanes; l++) {
+                if (k[l] > si->size) continue;
+
+                const void *key = src + ((base + l) * si->elem_size);
+                si_prefetch_descendants(si, k[l]);
+                k[l] = 2 * k[l] + (si->cmp(SI_PTR_FROM_IDX(si, k[l]), key) < 0);
+            }
+        }
+
+        for (size_t l = 0; l < lanes; l++) {
+            size_t p            = si_resolve(k[l]);
+            o_indices[base + l] = p ? si->rank[p] : si->size;
+        }
+    }
+}
+
+size_t si_size(const static_index *si) {
+    return si ? si->size : 0;
+}
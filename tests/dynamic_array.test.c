@@ -2,6 +2,7 @@
 
 #include <criterion/criterion.h>
 #include <criterion/logging.h>
+#include <stdint.h>
 
 Test(dynamic_array, create) {
     // da_create() should return a valid dynamic array.
@@ -207,6 +208,45 @@ Test(dynamic_array, erase) {
     da_destroy(arr);
 }
 
+Test(dynamic_array, erase_range) {
+    // da_erase_range() should erase the elements at indices [first, last).
+    dynamic_array *arr = da_create(sizeof(size_t));
+    cr_assert_not_null(arr);
+
+    for (size_t i = 0; i < 10; i++) da_push(arr, &i);
+
+    size_t erased[3];
+    da_erase_range(arr, 2, 5, erased);
+
+    cr_assert_eq(da_size(arr), 7);
+    for (size_t i = 0; i < 3; i++) cr_assert_eq(erased[i], 2 + i);
+    cr_assert_eq(*(size_t *)da_get(arr, 1), 1);
+    cr_assert_eq(*(size_t *)da_get(arr, 2), 5);
+    cr_assert_eq(*(size_t *)da_back(arr), 9);
+
+    // da_erase_range() should erase through the end of the dynamic array.
+    da_erase_range(arr, 4, 7, NULL);
+
+    cr_assert_eq(da_size(arr), 4);
+    cr_assert_eq(*(size_t *)da_back(arr), 6);
+
+    da_destroy(arr);
+
+    // da_erase_range() should do nothing if given a NULL dynamic array.
+    da_erase_range(NULL, 0, 1, NULL);
+
+    // da_erase_range() should do nothing if given an empty or out of bounds range.
+    arr = da_create_n(sizeof(size_t), 10, &(size_t){42});
+
+    da_erase_range(arr, 5, 5, NULL);
+    da_erase_range(arr, 6, 5, NULL);
+    da_erase_range(arr, 5, 11, NULL);
+
+    cr_assert_eq(da_size(arr), 10);
+
+    da_destroy(arr);
+}
+
 Test(dynamic_array, push) {
     // da_push() should push the element onto the end of the dynamic array.
     dynamic_array *arr = da_create_n(sizeof(size_t), 10, &(size_t){42});
@@ -232,6 +272,35 @@ Test(dynamic_array, push) {
     da_destroy(arr);
 }
 
+Test(dynamic_array, append) {
+    // da_append() should push the elements onto the end of the dynamic array.
+    dynamic_array *arr = da_create_n(sizeof(size_t), 10, &(size_t){42});
+    cr_assert_not_null(arr);
+
+    size_t elems[100];
+    for (size_t i = 0; i < 100; i++) elems[i] = i;
+
+    da_append(arr, elems, 100);
+
+    cr_assert_eq(da_size(arr), 110);
+    cr_assert_geq(da_capacity(arr), 110);
+    for (size_t i = 0; i < 100; i++) cr_assert_eq(*(size_t *)da_get(arr, 10 + i), i);
+
+    da_destroy(arr);
+
+    // da_append() should do nothing if given a NULL dynamic array.
+    da_append(NULL, elems, 100);
+
+    // da_append() should do nothing if given NULL elements.
+    arr = da_create_n(sizeof(size_t), 10, &(size_t){42});
+
+    da_append(arr, NULL, 100);
+
+    cr_assert_eq(da_size(arr), 10);
+
+    da_destroy(arr);
+}
+
 Test(dynamic_array, pop) {
     // da_pop() should pop the element from the end of the dynamic array.
     dynamic_array *arr = da_create_n(sizeof(size_t), 10, &(size_t){42});
@@ -343,6 +412,17 @@ Test(dynamic_array, resize) {
 
     da_destroy(arr);
 
+    // da_resize() should leave new elements uninitialized if given a NULL initial value.
+    arr = da_create_n(sizeof(size_t), 10, &(size_t){42});
+    cr_assert_not_null(arr);
+
+    da_resize(arr, 20, NULL);
+
+    cr_assert_eq(da_size(arr), 20);
+    for (size_t i = 0; i < 10; i++) cr_assert_eq(*(size_t *)da_get(arr, i), 42);
+
+    da_destroy(arr);
+
     // da_resize() should do nothing if given a NULL dynamic array.
     da_resize(NULL, 0, &(size_t){42});
 }
@@ -358,6 +438,19 @@ Test(dynamic_array, reserve) {
 
     da_destroy(arr);
 
+    // da_reserve() should leave the dynamic array unchanged if the storage cannot be allocated.
+    arr = da_create_n(sizeof(size_t), 10, &(size_t){42});
+    cr_assert_not_null(arr);
+
+    size_t capacity = da_capacity(arr);
+    da_reserve(arr, SIZE_MAX / 2);
+
+    cr_assert_eq(da_size(arr), 10);
+    cr_assert_eq(da_capacity(arr), capacity);
+    for (size_t i = 0; i < da_size(arr); i++) cr_assert_eq(*(size_t *)da_get(arr, i), 42);
+
+    da_destroy(arr);
+
     // da_reserve() should do nothing if given a NULL dynamic array.
     da_reserve(NULL, 0);
 }
@@ -418,3 +511,16 @@ Test(dynamic_array, data) {
     // da_data() should return NULL if given a NULL dynamic array.
     cr_assert_null(da_data(NULL));
 }
+
+Test(dynamic_array, elem_size) {
+    // da_elem_size() should return the element size of the dynamic array.
+    dynamic_array *arr = da_create(sizeof(size_t));
+    cr_assert_not_null(arr);
+
+    cr_assert_eq(da_elem_size(arr), sizeof(size_t));
+
+    da_destroy(arr);
+
+    // da_elem_size() should return 0 if given a NULL dynamic array.
+    cr_assert_eq(da_elem_size(NULL), 0);
+}
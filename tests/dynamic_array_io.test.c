@@ -0,0 +1,217 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "pyramid/dynamic_array_io.h"
+
+#include <criterion/criterion.h>
+#include <criterion/logging.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/// @brief Create an empty temporary file and write its path into path.
+static void make_temp_path(char path[32]) {
+    strcpy(path, "/tmp/pyramid-io-XXXXXX");
+    int fd = mkstemp(path);
+    cr_assert_geq(fd, 0);
+    close(fd);
+}
+
+/// @brief Parse newline-terminated decimal numbers into a dynamic array of size_t, failing on any
+/// other character.
+static size_t parse_lines(dynamic_array *da, const char *buf, size_t len, bool eof, void *arg) {
+    (void)eof;
+    (void)arg;
+
+    size_t used = 0;
+    for (;;) {
+        const char *nl = (const char *)memchr(buf + used, '\n', len - used);
+        if (!nl) break;
+
+        size_t value = 0;
+        for (const char *c = buf + used; c < nl; c++) {
+            if (*c < '0' || *c > '9') return DA_IO_PARSE_ERROR;
+            value = value * 10 + (size_t)(*c - '0');
+        }
+
+        size_t size = da_size(da);
+        da_push(da, &value);
+        if (da_size(da) != size + 1) return DA_IO_PARSE_ERROR;
+
+        used = (size_t)(nl - buf) + 1;
+    }
+
+    return used;
+}
+
+Test(dynamic_array_io, load_raw) {
+    // da_load() should read a packed array of elements spanning several chunks.
+    char path[32];
+    make_temp_path(path);
+
+    size_t n   = 3 * DA_IO_CHUNK_SIZE / sizeof(size_t) + 5;
+    FILE *file = fopen(path, "wb");
+    cr_assert_not_null(file);
+    for (size_t i = 0; i < n; i++) fwrite(&i, sizeof(i), 1, file);
+    fclose(file);
+
+    dynamic_array *arr = da_load(path, sizeof(size_t), NULL, NULL);
+
+    cr_assert_not_null(arr);
+    cr_assert_eq(da_size(arr), n);
+    for (size_t i = 0; i < n; i++) cr_assert_eq(*(size_t *)da_get(arr, i), i);
+
+    da_destroy(arr);
+
+    // da_load() should return NULL if the file's size is not a multiple of the element size.
+    file = fopen(path, "ab");
+    fputc(0, file);
+    fclose(file);
+
+    cr_assert_null(da_load(path, sizeof(size_t), NULL, NULL));
+
+    unlink(path);
+
+    // da_load() should return NULL if the file does not exist.
+    cr_assert_null(da_load(path, sizeof(size_t), NULL, NULL));
+}
+
+Test(dynamic_array_io, load_parse) {
+    // da_load() should carry records that straddle chunk boundaries over to the next chunk.
+    char path[32];
+    make_temp_path(path);
+
+    size_t n   = 1000000;
+    FILE *file = fopen(path, "w");
+    cr_assert_not_null(file);
+    for (size_t i = 0; i < n; i++) fprintf(file, "%zu\n", i * 7);
+    fclose(file);
+
+    dynamic_array *arr = da_load(path, sizeof(size_t), parse_lines, NULL);
+
+    cr_assert_not_null(arr);
+    cr_assert_eq(da_size(arr), n);
+    for (size_t i = 0; i < n; i++) cr_assert_eq(*(size_t *)da_get(arr, i), i * 7);
+
+    da_destroy(arr);
+
+    // da_load() should return NULL if the end of the file cannot be parsed.
+    file = fopen(path, "a");
+    fputs("123", file);
+    fclose(file);
+
+    cr_assert_null(da_load(path, sizeof(size_t), parse_lines, NULL));
+
+    // da_load() should return NULL if the parse function reports an error.
+    file = fopen(path, "w");
+    fputs("1\n2\nthree\n4\n", file);
+    fclose(file);
+
+    cr_assert_null(da_load(path, sizeof(size_t), parse_lines, NULL));
+
+    unlink(path);
+}
+
+Test(dynamic_array_io, flush) {
+    // da_flush_async() should write a snapshot that is unaffected by later modifications.
+    char path[32];
+    make_temp_path(path);
+
+    dynamic_array *arr = da_create(sizeof(size_t));
+    for (size_t i = 0; i < 100000; i++) da_push(arr, &i);
+
+    da_flush *flush = da_flush_async(arr, path);
+    cr_assert_not_null(flush);
+
+    for (size_t i = 0; i < da_size(arr); i++) da_set(arr, i, &(size_t){0});
+    da_destroy(arr);
+
+    cr_assert(da_flush_wait(flush));
+
+    arr = da_load(path, sizeof(size_t), NULL, NULL);
+
+    cr_assert_not_null(arr);
+    cr_assert_eq(da_size(arr), 100000);
+    for (size_t i = 0; i < da_size(arr); i++) cr_assert_eq(*(size_t *)da_get(arr, i), i);
+
+    da_destroy(arr);
+    unlink(path);
+
+    // da_flush_async() should return NULL if given a NULL dynamic array or path.
+    arr = da_create(sizeof(size_t));
+    cr_assert_not_null(arr);
+
+    cr_assert_null(da_flush_async(NULL, path));
+    cr_assert_null(da_flush_async(arr, NULL));
+
+    // da_flush_async() should return NULL if the destination cannot be written to.
+    cr_assert_null(da_flush_async(arr, "/nonexistent/pyramid-io"));
+
+    da_destroy(arr);
+
+    // da_flush_wait() should return false if given a NULL flush.
+    cr_assert_not(da_flush_wait(NULL));
+}
+
+/// @brief Return the number of files in the same directory as path whose names start with the name
+/// of the file at path followed by a dot, i.e. the temporary files left behind by flushes to path.
+static size_t count_temp_files(const char *path) {
+    const char *name = strrchr(path, '/') + 1;
+    size_t name_len  = strlen(name);
+
+    char dir[32];
+    memcpy(dir, path, (size_t)(name - path));
+    dir[name - path] = '\0';
+
+    DIR *d = opendir(dir);
+    cr_assert_not_null(d);
+
+    size_t count = 0;
+    for (struct dirent *e = readdir(d); e; e = readdir(d)) {
+        if (!strncmp(e->d_name, name, name_len) && e->d_name[name_len] == '.') count++;
+    }
+
+    closedir(d);
+    return count;
+}
+
+Test(dynamic_array_io, flush_concurrent) {
+    // Overlapping flushes to the same path should each write a whole snapshot, so the file ends up
+    // holding exactly one of them.
+    char path[32];
+    make_temp_path(path);
+
+    size_t sizes[] = {64 << 20, 16 << 20};
+    char fills[]   = {'A', 'B'};
+    dynamic_array *arrs[2];
+    da_flush *flushes[2];
+
+    // Both arrays are filled before either flush starts, so that the second flush begins while the
+    // first is still writing.
+    for (size_t k = 0; k < 2; k++) {
+        arrs[k] = da_create_n(sizeof(char), sizes[k], &fills[k]);
+        cr_assert_not_null(arrs[k]);
+    }
+    for (size_t k = 0; k < 2; k++) {
+        flushes[k] = da_flush_async(arrs[k], path);
+        cr_assert_not_null(flushes[k]);
+    }
+    for (size_t k = 0; k < 2; k++) da_destroy(arrs[k]);
+
+    cr_assert(da_flush_wait(flushes[0]));
+    cr_assert(da_flush_wait(flushes[1]));
+    cr_assert_eq(count_temp_files(path), 0);
+
+    dynamic_array *arr = da_load(path, sizeof(char), NULL, NULL);
+    cr_assert_not_null(arr);
+
+    size_t k = (*(char *)da_get(arr, 0) == 'A') ? 0 : 1;
+    cr_assert_eq(da_size(arr), sizes[k]);
+
+    const char *data = (const char *)da_data(arr);
+    for (size_t i = 0; i < da_size(arr); i++) cr_assert_eq(data[i], fills[k]);
+
+    da_destroy(arr);
+    unlink(path);
+}
@@ -0,0 +1,279 @@
+#include "pyramid/dynamic_array.h"
+
+#include <criterion/criterion.h>
+#include <criterion/logging.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/// @brief The number of operations applied to each randomized sequence.
+#define STRESS_OPS 20000
+
+/// @brief The number of randomized sequences to run.
+#define STRESS_SEEDS 16
+
+/// @brief The largest number of elements a randomized sequence is allowed to grow to.
+#define STRESS_MAX_ELEMS 512
+
+/// @brief The largest slowdown tolerated when the number of elements pushed grows 16x. Amortized
+/// constant-time pushes stay around 16-30x; quadratic growth lands near 256x.
+#define PUSH_SCALING_LIMIT 64.0
+
+/// @brief The largest slowdown tolerated for da_erase_range relative to a single memmove of the
+/// elements it shifts. Shifting one element at a time is slower by a factor of the range length.
+#define ERASE_RANGE_LIMIT 8.0
+
+/// @brief The length of the range erased by the erase_range guards, and so the slowdown expected of
+/// an implementation that shifts one element at a time.
+#define ERASE_RANGE_LENGTH 64
+
+/// @brief A trivially correct reference model of a dynamic array of size_t.
+struct model {
+    size_t size;
+    size_t data[STRESS_MAX_ELEMS];
+};
+
+static uint64_t xorshift(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/// @brief Assert that a dynamic array holds exactly the contents of a reference model.
+static void assert_matches(const dynamic_array *arr, const struct model *m) {
+    cr_assert_eq(da_size(arr), m->size);
+    cr_assert_geq(da_capacity(arr), da_size(arr));
+    cr_assert_eq(da_is_empty(arr), m->size == 0);
+    if (m->size) cr_assert_eq(memcmp(da_data(arr), m->data, m->size * sizeof(size_t)), 0);
+}
+
+/// @brief Apply one random operation to both a dynamic array and a reference model. Indices are
+/// drawn from slightly past the end of the array so that out of bounds calls are exercised too.
+static void apply_random_op(dynamic_array *arr, struct model *m, uint64_t *state) {
+    size_t value = (size_t)xorshift(state);
+    size_t i     = (size_t)(xorshift(state) % (m->size + 2));
+    size_t j     = (size_t)(xorshift(state) % (m->size + 2));
+    size_t room  = STRESS_MAX_ELEMS - m->size;
+
+    switch (xorshift(state) % 11) {
+        case 0:
+        case 1:
+            if (!room) break;
+            da_push(arr, &value);
+            m->data[m->size++] = value;
+            break;
+        case 2: {
+            size_t popped = 0;
+            da_pop(arr, &popped);
+            if (m->size) cr_assert_eq(popped, m->data[--m->size]);
+            break;
+        }
+        case 3:
+            if (!room) break;
+            da_insert(arr, i, &value);
+            if (i > m->size) break;
+            memmove(&m->data[i + 1], &m->data[i], (m->size - i) * sizeof(size_t));
+            m->data[i] = value;
+            m->size++;
+            break;
+        case 4: {
+            size_t erased = 0;
+            da_erase(arr, i, &erased);
+            if (i >= m->size) break;
+            cr_assert_eq(erased, m->data[i]);
+            memmove(&m->data[i], &m->data[i + 1], (m->size - i - 1) * sizeof(size_t));
+            m->size--;
+            break;
+        }
+        case 5: {
+            size_t first = (i < j) ? i : j;
+            size_t last  = (i < j) ? j : i;
+            size_t erased[STRESS_MAX_ELEMS + 2];
+            da_erase_range(arr, first, last, erased);
+            if (first >= last || last > m->size) break;
+            cr_assert_eq(memcmp(erased, &m->data[first], (last - first) * sizeof(size_t)), 0);
+            memmove(&m->data[first], &m->data[last], (m->size - last) * sizeof(size_t));
+            m->size -= last - first;
+            break;
+        }
+        case 6:
+            da_set(arr, i, &value);
+            if (i < m->size) m->data[i] = value;
+            break;
+        case 7: {
+            size_t n = (size_t)(xorshift(state) % STRESS_MAX_ELEMS);
+            if (value % 2) {
+                da_resize(arr, n, &value);
+                for (size_t k = m->size; k < n; k++) m->data[k] = value;
+            } else {
+                // New elements are uninitialized, so adopt whatever the array holds.
+                da_resize(arr, n, NULL);
+                if (n > m->size) {
+                    size_t *data = (size_t *)da_data(arr);
+                    memcpy(&m->data[m->size], &data[m->size], (n - m->size) * sizeof(size_t));
+                }
+            }
+            m->size = n;
+            break;
+        }
+        case 8:
+            da_reserve(arr, (size_t)(xorshift(state) % (2 * STRESS_MAX_ELEMS)));
+            break;
+        case 9: {
+            size_t n = (size_t)(xorshift(state) % 8);
+            if (n > room) n = room;
+            size_t elems[8];
+            for (size_t k = 0; k < n; k++) elems[k] = value + k;
+            da_append(arr, elems, n);
+            memcpy(&m->data[m->size], elems, n * sizeof(size_t));
+            m->size += n;
+            break;
+        }
+        case 10: {
+            if (value % 16) break;
+            dynamic_array *dup = da_dup(arr);
+            cr_assert_not_null(dup);
+            assert_matches(dup, m);
+            da_destroy(dup);
+            da_clear(arr);
+            m->size = 0;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+Test(dynamic_array_stress, differential) {
+    // Long random sequences of operations should leave a dynamic array identical to the model.
+    static struct model m;
+
+    for (uint64_t seed = 1; seed <= STRESS_SEEDS; seed++) {
+        uint64_t state     = seed * 0x9e3779b97f4a7c15ull;
+        dynamic_array *arr = da_create(sizeof(size_t));
+        cr_assert_not_null(arr);
+        m.size = 0;
+
+        for (size_t op = 0; op < STRESS_OPS; op++) {
+            apply_random_op(arr, &m, &state);
+            assert_matches(arr, &m);
+        }
+
+        da_destroy(arr);
+    }
+}
+
+/// @brief Return the shortest of several timings of pushing n elements onto an empty array.
+static double time_push(size_t n) {
+    double best = 1e9;
+    for (size_t rep = 0; rep < 5; rep++) {
+        dynamic_array *arr = da_create(sizeof(size_t));
+        cr_assert_not_null(arr);
+
+        double start = now();
+        for (size_t i = 0; i < n; i++) da_push(arr, &i);
+        double elapsed = now() - start;
+
+        cr_assert_eq(da_size(arr), n);
+        da_destroy(arr);
+
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+/// @brief A function which erases the elements at indices [first, last) from a dynamic array.
+typedef void (*erase_range_function)(dynamic_array *, size_t, size_t);
+
+/// @brief Erase a range with da_erase_range, which shifts the tail once.
+static void erase_range_at_once(dynamic_array *arr, size_t first, size_t last) {
+    da_erase_range(arr, first, last, NULL);
+}
+
+/// @brief Erase a range the slow way, shifting the tail once per element, to check that the guard
+/// on da_erase_range can tell the difference.
+static void erase_range_one_by_one(dynamic_array *arr, size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) da_erase(arr, first, NULL);
+}
+
+/// @brief Return the shortest of several timings of erasing ERASE_RANGE_LENGTH elements from a
+/// quarter of the way into n elements with erase, and write the shortest of several timings of
+/// moving the same tail with a single memmove into o_baseline.
+static double time_erase_range(size_t n, erase_range_function erase, double *o_baseline) {
+    size_t first = n / 4;
+    size_t last  = first + ERASE_RANGE_LENGTH;
+    double best  = 1e9;
+    *o_baseline  = 1e9;
+
+    for (size_t rep = 0; rep < 5; rep++) {
+        dynamic_array *arr = da_create_n(sizeof(size_t), n, &(size_t){42});
+        cr_assert_not_null(arr);
+
+        double start = now();
+        erase(arr, first, last);
+        double elapsed = now() - start;
+
+        cr_assert_eq(da_size(arr), n - ERASE_RANGE_LENGTH);
+        if (elapsed < best) best = elapsed;
+
+        // The array's storage is still allocated and touched, so reuse it for the baseline.
+        // The source is read through a volatile pointer so that the compiler cannot prove the
+        // ranges disjoint and lower the move to a memcpy.
+        size_t *data          = (size_t *)da_data(arr);
+        size_t *volatile tail = &data[last];
+        start                 = now();
+        memmove(&data[first], tail, (n - last) * sizeof(size_t));
+        elapsed = now() - start;
+
+        if (elapsed < *o_baseline) *o_baseline = elapsed;
+        da_destroy(arr);
+    }
+    return best;
+}
+
+Test(dynamic_array_stress, push_scaling, .timeout = 60) {
+    // da_push() should only reallocate a logarithmic number of times.
+    dynamic_array *arr = da_create(sizeof(size_t));
+    cr_assert_not_null(arr);
+
+    size_t reallocations = 0;
+    for (size_t i = 0; i < (1 << 20); i++) {
+        size_t capacity = da_capacity(arr);
+        da_push(arr, &i);
+        if (da_capacity(arr) != capacity) reallocations++;
+    }
+
+    cr_assert_leq(reallocations, 21);
+
+    da_destroy(arr);
+
+    // da_push() should take amortized constant time.
+    double small = time_push(1 << 16);
+    double large = time_push(1 << 20);
+    cr_log_info("push: %.3f ms for 2^16, %.3f ms for 2^20", small * 1e3, large * 1e3);
+
+    cr_assert_lt(large, small * PUSH_SCALING_LIMIT);
+}
+
+Test(dynamic_array_stress, erase_range_scaling, .timeout = 60) {
+    // da_erase_range() should shift the tail of the array once, no matter how long the range is, so
+    // it should cost about as much as a single memmove of the tail.
+    double baseline;
+    double elapsed = time_erase_range(1 << 20, erase_range_at_once, &baseline);
+    cr_log_info("erase_range: %.3f ms, memmove: %.3f ms", elapsed * 1e3, baseline * 1e3);
+
+    cr_assert_lt(elapsed, baseline * ERASE_RANGE_LIMIT);
+
+    // Shifting the tail once per erased element should fail the same guard.
+    elapsed = time_erase_range(1 << 20, erase_range_one_by_one, &baseline);
+    cr_log_info("erase one by one: %.3f ms, memmove: %.3f ms", elapsed * 1e3, baseline * 1e3);
+
+    cr_assert_geq(elapsed, baseline * ERASE_RANGE_LIMIT);
+}
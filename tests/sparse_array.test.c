@@ -0,0 +1,191 @@
+#include "pyramid/sparse_array.h"
+
+#include <criterion/criterion.h>
+#include <criterion/logging.h>
+
+Test(sparse_array, create) {
+    // sa_create() should return a valid, unpopulated sparse array.
+    sparse_array *arr = sa_create(sizeof(size_t), 1000000);
+
+    cr_assert_not_null(arr);
+    cr_assert_eq(sa_size(arr), 1000000);
+    cr_assert_eq(sa_count(arr), 0);
+    cr_assert_null(sa_get(arr, 0));
+    cr_assert_eq(sa_next(arr, 0), sa_size(arr));
+
+    sa_destroy(arr);
+
+    // sa_create() should return a valid sparse array if given a size of 0.
+    arr = sa_create(sizeof(size_t), 0);
+
+    cr_assert_not_null(arr);
+    cr_assert_eq(sa_size(arr), 0);
+    cr_assert_null(sa_get(arr, 0));
+
+    sa_destroy(arr);
+
+    // sa_create() should return NULL if given an element size of 0.
+    cr_assert_null(sa_create(0, 10));
+}
+
+Test(sparse_array, set_get) {
+    // sa_set() should populate the slot at index i, and sa_get() should return it.
+    sparse_array *arr = sa_create(sizeof(size_t), 1000000);
+    cr_assert_not_null(arr);
+
+    sa_set(arr, 0, &(size_t){1});
+    sa_set(arr, 123456, &(size_t){2});
+    sa_set(arr, 999999, &(size_t){3});
+
+    cr_assert_eq(sa_count(arr), 3);
+    cr_assert_eq(*(size_t *)sa_get(arr, 0), 1);
+    cr_assert_eq(*(size_t *)sa_get(arr, 123456), 2);
+    cr_assert_eq(*(size_t *)sa_get(arr, 999999), 3);
+    cr_assert(sa_contains(arr, 123456));
+
+    // sa_get() should return NULL for an unpopulated slot, even if its page is allocated.
+    cr_assert_null(sa_get(arr, 1));
+    cr_assert_not(sa_contains(arr, 1));
+
+    // sa_set() should overwrite a populated slot without changing the count.
+    sa_set(arr, 0, &(size_t){4});
+
+    cr_assert_eq(sa_count(arr), 3);
+    cr_assert_eq(*(size_t *)sa_get(arr, 0), 4);
+
+    // sa_set() should do nothing if given an index that is out of bounds or a NULL element.
+    sa_set(arr, 1000000, &(size_t){5});
+    sa_set(arr, 1, NULL);
+
+    cr_assert_eq(sa_count(arr), 3);
+    cr_assert_null(sa_get(arr, 1000000));
+
+    sa_destroy(arr);
+
+    // sa_set() and sa_get() should do nothing if given a NULL sparse array.
+    sa_set(NULL, 0, &(size_t){42});
+    cr_assert_null(sa_get(NULL, 0));
+}
+
+Test(sparse_array, erase) {
+    // sa_erase() should unpopulate the slot at index i and release its page once it is empty.
+    sparse_array *arr = sa_create(sizeof(size_t), 1000000);
+    cr_assert_not_null(arr);
+
+    sa_set(arr, 10, &(size_t){10});
+    sa_set(arr, 11, &(size_t){11});
+
+    sa_stats stats;
+    sa_get_stats(arr, &stats);
+    cr_assert_eq(stats.pages, 1);
+
+    size_t erased = 0;
+    sa_erase(arr, 10, &erased);
+
+    cr_assert_eq(erased, 10);
+    cr_assert_eq(sa_count(arr), 1);
+    cr_assert_null(sa_get(arr, 10));
+
+    sa_erase(arr, 11, NULL);
+    sa_get_stats(arr, &stats);
+
+    cr_assert_eq(sa_count(arr), 0);
+    cr_assert_eq(stats.pages, 0);
+
+    // sa_erase() should do nothing if the slot is not populated or out of bounds.
+    erased = 42;
+    sa_erase(arr, 10, &erased);
+    sa_erase(arr, 1000000, &erased);
+
+    cr_assert_eq(erased, 42);
+
+    sa_destroy(arr);
+
+    // sa_erase() should do nothing if given a NULL sparse array.
+    sa_erase(NULL, 0, NULL);
+}
+
+Test(sparse_array, next) {
+    // sa_next() should visit every populated slot in order, and nothing else.
+    sparse_array *arr = sa_create(sizeof(size_t), 10000000);
+    cr_assert_not_null(arr);
+
+    size_t ids[] = {3, 63, 64, 1023, 1024, 5000, 65535, 9999999};
+    size_t n     = sizeof(ids) / sizeof(ids[0]);
+    for (size_t k = 0; k < n; k++) sa_set(arr, ids[k], &ids[k]);
+
+    size_t visited = 0;
+    for (size_t i = sa_next(arr, 0); i < sa_size(arr); i = sa_next(arr, i + 1)) {
+        cr_assert_lt(visited, n);
+        cr_assert_eq(i, ids[visited]);
+        cr_assert_eq(*(size_t *)sa_get(arr, i), ids[visited]);
+        visited++;
+    }
+
+    cr_assert_eq(visited, n);
+
+    // sa_next() should start from the given index.
+    cr_assert_eq(sa_next(arr, 64), 64);
+    cr_assert_eq(sa_next(arr, 65), 1023);
+
+    sa_destroy(arr);
+
+    // sa_next() should return 0 if given a NULL sparse array.
+    cr_assert_eq(sa_next(NULL, 0), 0);
+}
+
+Test(sparse_array, clear) {
+    // sa_clear() should unpopulate every slot and release every page.
+    sparse_array *arr = sa_create(sizeof(size_t), 1000000);
+    cr_assert_not_null(arr);
+
+    for (size_t i = 0; i < 1000000; i += 1000) sa_set(arr, i, &i);
+
+    sa_clear(arr);
+
+    sa_stats stats;
+    sa_get_stats(arr, &stats);
+
+    cr_assert_eq(sa_count(arr), 0);
+    cr_assert_eq(stats.pages, 0);
+    cr_assert_eq(sa_next(arr, 0), sa_size(arr));
+
+    sa_destroy(arr);
+
+    // sa_clear() should do nothing if given a NULL sparse array.
+    sa_clear(NULL);
+}
+
+Test(sparse_array, stats) {
+    // sa_get_stats() should only account for pages that have been written to.
+    sparse_array *arr = sa_create(sizeof(size_t), 100000000);
+    cr_assert_not_null(arr);
+
+    sa_stats empty;
+    sa_get_stats(arr, &empty);
+
+    cr_assert_eq(empty.populated, 0);
+    cr_assert_eq(empty.pages, 0);
+    cr_assert_eq(empty.slots, 0);
+
+    for (size_t i = 0; i < 100; i++) sa_set(arr, i * 1000000, &i);
+
+    sa_stats stats;
+    sa_get_stats(arr, &stats);
+
+    cr_assert_eq(stats.populated, 100);
+    cr_assert_eq(stats.pages, 100);
+    cr_assert_geq(stats.slots, 100);
+    cr_assert_gt(stats.bytes, empty.bytes);
+
+    // A sparse array should use a small fraction of the memory of a dense one.
+    cr_assert_lt(stats.bytes, 100000000 * sizeof(size_t) / 10);
+
+    sa_destroy(arr);
+
+    // sa_get_stats() should report zeros if given a NULL sparse array.
+    sa_get_stats(NULL, &stats);
+
+    cr_assert_eq(stats.populated, 0);
+    cr_assert_eq(stats.bytes, 0);
+}
@@ -0,0 +1,139 @@
+#include "pyramid/static_index.h"
+
+#include <criterion/criterion.h>
+#include <criterion/logging.h>
+
+static int compare_size_t(const void *a, const void *b) {
+    size_t x = *(const size_t *)a;
+    size_t y = *(const size_t *)b;
+    return (x > y) - (x < y);
+}
+
+/// @brief Return a dynamic array holding the even numbers 0, 2, ..., 2 * (n - 1).
+static dynamic_array *make_evens(size_t n) {
+    dynamic_array *keys = da_create(sizeof(size_t));
+    for (size_t i = 0; i < n; i++) da_push(keys, &(size_t){2 * i});
+    return keys;
+}
+
+/// @brief Return the result of a plain binary search for the first key not less than key.
+static size_t reference_lower_bound(const dynamic_array *keys, size_t key) {
+    const size_t *data = (const size_t *)da_data(keys);
+    size_t lo = 0, hi = da_size(keys);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (data[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+Test(static_index, create) {
+    // si_create() should return a valid static index.
+    dynamic_array *keys = make_evens(100);
+    static_index *si    = si_create(keys, compare_size_t);
+
+    cr_assert_not_null(si);
+    cr_assert_eq(si_size(si), 100);
+
+    si_destroy(si);
+
+    // si_create() should return a valid, empty static index if given no keys.
+    da_clear(keys);
+    si = si_create(keys, compare_size_t);
+
+    cr_assert_not_null(si);
+    cr_assert_eq(si_size(si), 0);
+    cr_assert_eq(si_lower_bound(si, &(size_t){0}), 0);
+
+    si_destroy(si);
+
+    // si_create() should return NULL if given NULL keys or a NULL comparator.
+    cr_assert_null(si_create(NULL, compare_size_t));
+    cr_assert_null(si_create(keys, NULL));
+
+    da_destroy(keys);
+}
+
+Test(static_index, lower_bound) {
+    // si_lower_bound() should agree with binary search for every size of tree, including ones
+    // whose last level is partially filled.
+    for (size_t n = 1; n <= 70; n++) {
+        dynamic_array *keys = make_evens(n);
+        static_index *si    = si_create(keys, compare_size_t);
+        cr_assert_not_null(si);
+
+        for (size_t key = 0; key <= 2 * n + 1; key++) {
+            cr_assert_eq(si_lower_bound(si, &key), reference_lower_bound(keys, key));
+        }
+
+        si_destroy(si);
+        da_destroy(keys);
+    }
+
+    // si_lower_bound() should return 0 if given a NULL static index.
+    cr_assert_eq(si_lower_bound(NULL, &(size_t){0}), 0);
+}
+
+Test(static_index, find) {
+    // si_find() should return the index of a matching key, or si_size() if there is none.
+    dynamic_array *keys = make_evens(1000);
+    static_index *si    = si_create(keys, compare_size_t);
+    cr_assert_not_null(si);
+
+    for (size_t key = 0; key < 2000; key++) {
+        size_t i = si_find(si, &key);
+        if (key % 2) cr_assert_eq(i, si_size(si));
+        else cr_assert_eq(i, key / 2);
+    }
+
+    cr_assert_eq(si_find(si, &(size_t){5000}), si_size(si));
+
+    si_destroy(si);
+    da_destroy(keys);
+}
+
+Test(static_index, lower_bound_batch) {
+    // si_lower_bound_batch() should agree with si_lower_bound(), including for a final group of
+    // searches smaller than a full batch.
+    dynamic_array *keys = make_evens(4099);
+    static_index *si    = si_create(keys, compare_size_t);
+    cr_assert_not_null(si);
+
+    size_t n = 1001;
+    size_t queries[1001];
+    size_t results[1001];
+    for (size_t i = 0; i < n; i++) queries[i] = (i * 7919) % (2 * 4099 + 3);
+
+    si_lower_bound_batch(si, queries, n, results);
+
+    for (size_t i = 0; i < n; i++) cr_assert_eq(results[i], si_lower_bound(si, &queries[i]));
+
+    si_destroy(si);
+    da_destroy(keys);
+}
+
+Test(static_index, rebuild) {
+    // si_rebuild() should replace the keys within the static index.
+    dynamic_array *keys = make_evens(10);
+    static_index *si    = si_create(keys, compare_size_t);
+    cr_assert_not_null(si);
+
+    dynamic_array *larger = make_evens(500);
+    cr_assert(si_rebuild(si, larger));
+    cr_assert_eq(si_size(si), 500);
+    cr_assert_eq(si_find(si, &(size_t){998}), 499);
+
+    cr_assert(si_rebuild(si, keys));
+    cr_assert_eq(si_size(si), 10);
+    cr_assert_eq(si_find(si, &(size_t){998}), si_size(si));
+
+    // si_rebuild() should fail if given keys of a different element size.
+    dynamic_array *other = da_create(sizeof(char));
+    cr_assert_not(si_rebuild(si, other));
+
+    da_destroy(other);
+    da_destroy(larger);
+    si_destroy(si);
+    da_destroy(keys);
+}